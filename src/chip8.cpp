@@ -1,5 +1,6 @@
 #include "chip8.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <chrono>
@@ -38,12 +39,19 @@ namespace chip8 {
 
     using namespace std::chrono;
 
-    const Display &Interpreter::GetDisplay() const {
+    template<typename Debug>
+    const Display &Interpreter<Debug>::GetDisplay() const {
         return display_;
     }
 
+    template<typename Debug>
+    const Diagnostics &Interpreter<Debug>::GetDiagnostics() const {
+        return diagnostics_;
+    }
+
     // Run interpreter a certain ips (instructions per second)
-    int Interpreter::Run(const std::filesystem::path &path, const u_int16_t ips) {
+    template<typename Debug>
+    int Interpreter<Debug>::Run(const std::filesystem::path &path, const u_int16_t ips) {
         // Load ROM-file into memory
         if (LoadROM(path) != 0) {
             return 1;
@@ -53,10 +61,15 @@ namespace chip8 {
         PC_ = 0x200;
 
         const auto delay_ips = 1000ms / ips;
+        const auto cycle_time = duration_cast<nanoseconds>(1s) / ips; // Emulated duration of one instruction
         constexpr auto delay = 1000ms / 60; // delay timer
 
-        auto next_ips = std::chrono::steady_clock::now();
-        auto next = std::chrono::steady_clock::now(); // delay timer
+        auto start = std::chrono::steady_clock::now();
+        auto next_ips = start;
+        auto next = start; // delay timer
+
+        u_int64_t cycles = 0; // Executed instructions
+        u_int64_t frames = 0; // Timer ticks in cycle timing mode
 
         bool quit = false;
         while (true) {
@@ -68,38 +81,103 @@ namespace chip8 {
                 break;
             }
 
+            // Breakpoints and single stepping, time spent in the debugger doesn't count as emulated time
+            if constexpr (Debug::enabled) {
+                const auto paused = debugger_.Update(*this, quit);
+                if (quit) {
+                    break;
+                }
+                start += paused;
+                next_ips += paused;
+                next += paused;
+                now += paused;
+            }
+
             // Fetch
             const auto i = FetchInstruction();
 
             // We increment PC_ here already: next instruction
             PC_ += 2;
 
-            // For debugging purposes
-            // std::cout << "Handling instruction: " << "0x" << std::hex << i() << '\n';
-
             // Execute instruction
             ExecuteInstruction(i);
+            ++cycles;
 
-            // Render display
-            display_.Render();
+            // Display wait quirk: after drawing, idle until the next frame starts
+            const bool wait_for_frame = config_.display_wait_ && i.N1() == 0xD;
 
-            // Update delay timer
-            if (now > next) {
-                ++delay_timer_;
-                ++sound_timer_;
-                next += delay;
+            if (config_.cycle_timing_) {
+                if (wait_for_frame) {
+                    // cycles already counts the Dxyn, so it ran in frame (cycles - 1) * 60 / ips
+                    cycles = FirstCycleOfFrame((cycles - 1) * 60 / ips + 1, ips);
+                }
+
+                // Update delay timer, exactly 60 times per ips instructions
+                while (cycles * 60 / ips > frames) {
+                    TickTimers();
+                    ++frames;
+
+                    // Render display once per frame
+                    display_.Render();
+                }
+            } else {
+                // Render display
+                display_.Render();
+
+                // Update delay timer
+                if (now > next) {
+                    TickTimers();
+                    next += delay;
+                }
+            }
+
+            if (config_.unthrottled_) {
+                continue;
             }
 
             // Sleep until next
-            next_ips += delay_ips;
+            if (config_.cycle_timing_) {
+                next_ips = start + cycle_time * cycles;
+            } else {
+                next_ips += delay_ips;
+                if (wait_for_frame) {
+                    next_ips = std::max(next_ips, next);
+                }
+            }
             std::this_thread::sleep_until(next_ips);
         }
 
         return 0;
     }
 
+    template<typename Debug>
+    u_int64_t Interpreter<Debug>::FirstCycleOfFrame(const u_int64_t frame, const u_int16_t ips) {
+        return (frame * ips + 59) / 60;
+    }
+
+    template<typename Debug>
+    void Interpreter<Debug>::TickTimers() {
+        ++delay_timer_;
+        ++sound_timer_;
+    }
+
+    template<typename Debug>
+    void Interpreter<Debug>::OnRead(const u_int16_t addr, const u_int16_t size) {
+        if constexpr (Debug::enabled) {
+            debugger_.OnAccess(PC_ - 2, addr, size, Debugger::Read);
+        }
+    }
+
+    template<typename Debug>
+    void Interpreter<Debug>::OnWrite(const u_int16_t addr, const u_int16_t size) {
+        if constexpr (Debug::enabled) {
+            debugger_.OnAccess(PC_ - 2, addr, size, Debugger::Write);
+        }
+    }
+
 
-    int Interpreter::LoadROM(const std::filesystem::path &path) {
+    template<typename Debug>
+    int Interpreter<Debug>::LoadROM(const std::filesystem::path &path) {
         std::ifstream rom(path, std::ios::in);
 
         if (!rom) {
@@ -116,12 +194,14 @@ namespace chip8 {
     }
 
 
-    Instruction Interpreter::FetchInstruction() const {
+    template<typename Debug>
+    Instruction Interpreter<Debug>::FetchInstruction() const {
         return {RAM_[PC_], RAM_[PC_ + 1]};
     }
 
 
-    void Interpreter::ExecuteInstruction(const Instruction i) {
+    template<typename Debug>
+    void Interpreter<Debug>::ExecuteInstruction(const Instruction i) {
         switch (i()) {
             case 0x00E0: // Clear display
             {
@@ -129,7 +209,10 @@ namespace chip8 {
                 return;
             }
             case 0x00EE: {
-                PC_ = stack_.Pop();
+                const auto PC = PC_ - 2;
+                if (!stack_.Pop(PC_)) {
+                    diagnostics_.Report(Fault::StackUnderflow, PC, i());
+                }
                 return;
             }
         }
@@ -145,7 +228,9 @@ namespace chip8 {
             }
             case 0x2: // Push PC to stack + jump
             {
-                stack_.Push(PC_);
+                if (!stack_.Push(PC_)) {
+                    diagnostics_.Report(Fault::StackOverflow, PC_ - 2, i());
+                }
                 PC_ = i.N234();
                 return;
             }
@@ -267,6 +352,7 @@ namespace chip8 {
                 const auto X = V_[i.N2()] % PIXELS_X;
                 auto y = V_[i.N3()] % PIXELS_Y;
                 V_[0xF] = 0;
+                OnRead(I_, i.N4());
 
                 for (auto n = 0; n < i.N4(); ++n) {
                     auto x = X;
@@ -342,12 +428,14 @@ namespace chip8 {
                         return;
                     }
                     case 0x33: {
+                        OnWrite(I_, 3);
                         RAM_[I_] = V_[i.N2()] / 100 % 10;
                         RAM_[I_ + 1] = V_[i.N2()] / 10 % 10;
                         RAM_[I_ + 2] = V_[i.N2()] % 10;
                         return;
                     }
                     case 0x55: {
+                        OnWrite(I_, i.N2() + 1);
                         for (auto n = 0; n <= i.N2() && n != sizeof(V_); ++n) {
                             RAM_[I_ + n] = V_[n];
                         }
@@ -357,6 +445,7 @@ namespace chip8 {
                         return;
                     }
                     case 0x65: {
+                        OnRead(I_, i.N2() + 1);
                         for (auto n = 0; n <= i.N2() && n != sizeof(V_); ++n) {
                             V_[n] = RAM_[I_ + n];
                         }
@@ -366,6 +455,9 @@ namespace chip8 {
             }
         }
 
-        std::cerr << "Unsupported instruction: " << "0x" << std::hex << i() << '\n';
+        diagnostics_.Report(Fault::UnsupportedInstruction, PC_ - 2, i());
     }
+
+    template class Interpreter<NoDebugger>;
+    template class Interpreter<Debugger>;
 } // chip8
\ No newline at end of file
@@ -1,11 +1,14 @@
 #pragma once
 
+#include "debugger.h"
+#include "diagnostics.h"
 #include "display.h"
 #include "keypad.h"
 #include "stack.h"
 
 #include <array>
 #include <filesystem>
+#include <iostream>
 
 using font = std::array<u_int8_t, 80>;
 constexpr font f = {0xF0, 0x90, 0x90, 0x90, 0xF0, // 0
@@ -31,6 +34,12 @@ namespace chip8 {
         bool shift_set_VY_{};
 
         bool fx55_incr_I_{};
+
+        bool cycle_timing_{}; // Derive timers from the instruction count instead of the wall clock
+
+        bool display_wait_{}; // Dxyn waits for the start of the next 60 Hz frame
+
+        bool unthrottled_{}; // Run as fast as possible, no sleeping between instructions
     };
 
     class Instruction {
@@ -57,7 +66,11 @@ namespace chip8 {
         u_int8_t byte2_{};
     };
 
+    // The Debug policy (NoDebugger or Debugger) decides at compile time whether debugger hooks are compiled in
+    template<typename Debug = NoDebugger>
     class Interpreter {
+        friend Debug;
+
     public:
         static constexpr auto font_address = 0x50;
 
@@ -69,6 +82,8 @@ namespace chip8 {
 
         [[nodiscard]] const Display &GetDisplay() const;
 
+        [[nodiscard]] const Diagnostics &GetDiagnostics() const;
+
     private:
         [[nodiscard]] Instruction FetchInstruction() const;
 
@@ -76,6 +91,14 @@ namespace chip8 {
 
         int LoadROM(const std::filesystem::path &path);
 
+        [[nodiscard]] static u_int64_t FirstCycleOfFrame(u_int64_t frame, u_int16_t ips);
+
+        void TickTimers();
+
+        void OnRead(u_int16_t addr, u_int16_t size); // RAM accessed through I
+
+        void OnWrite(u_int16_t addr, u_int16_t size);
+
         std::array<u_int8_t, 4096> RAM_{};
         std::array<u_int8_t, 16> V_{}; // Registers 0..F
         u_int16_t I_{}; // I register
@@ -86,6 +109,11 @@ namespace chip8 {
         Display display_{};
         Config config_{};
         Keypad keypad_{};
+        Diagnostics diagnostics_{std::cerr};
+        [[no_unique_address]] Debug debugger_{};
     };
 
+    extern template class Interpreter<NoDebugger>;
+    extern template class Interpreter<Debugger>;
+
 } // chip8
@@ -0,0 +1,239 @@
+#include "debugger.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace chip8 {
+    namespace {
+        const char *ToString(const Debugger::Access access) {
+            switch (access) {
+                case Debugger::Read:
+                    return "read";
+                case Debugger::Write:
+                    return "write";
+                case Debugger::ReadWrite:
+                    return "read/write";
+            }
+            return "?";
+        }
+
+        // Parse a hexadecimal number, with or without 0x prefix
+        bool ParseHex(const std::string &token, u_int16_t &value) {
+            try {
+                std::size_t pos = 0;
+                const auto v = std::stoul(token, &pos, 16);
+                if (pos != token.size() || v > 0xFFFF) {
+                    return false;
+                }
+                value = static_cast<u_int16_t>(v);
+                return true;
+            } catch (const std::exception &) {
+                return false;
+            }
+        }
+
+        bool ParseHex(std::istream &in, u_int16_t &value) {
+            std::string token;
+            return in >> token && ParseHex(token, value);
+        }
+
+        std::ostream &Hex(std::ostream &out, const unsigned value, const int width) {
+            return out << "0x" << std::hex << std::uppercase << std::setfill('0') << std::setw(width) << value
+                       << std::dec;
+        }
+
+        constexpr auto help = "Commands (addresses in hex):\n"
+                              "  s [n]                 step n instructions (default 1)\n"
+                              "  c                     continue\n"
+                              "  b <addr>              set breakpoint\n"
+                              "  d <addr>              delete breakpoint\n"
+                              "  w <addr> [len] [r|w]  set watchpoint on RAM[addr..addr+len), default read/write\n"
+                              "  u <addr>              remove watchpoints starting at addr\n"
+                              "  l                     list breakpoints and watchpoints\n"
+                              "  r                     print registers\n"
+                              "  m <addr> [len]        print memory\n"
+                              "  q                     quit\n";
+    }
+
+    void Debugger::OnAccess(const u_int16_t PC, const u_int16_t addr, const u_int16_t size, const Access access) {
+        if (size == 0) {
+            return;
+        }
+        for (const auto &watchpoint: watchpoints_) {
+            if ((watchpoint.access_ & access) && addr < watchpoint.end_ && watchpoint.start_ < addr + size) {
+                hits_.push_back({watchpoint, PC, addr, size, access});
+            }
+        }
+    }
+
+    bool Debugger::ShouldBreak(const u_int16_t PC) {
+        auto brk = paused_ || !hits_.empty();
+        if (steps_ > 0 && --steps_ == 0) {
+            brk = true;
+        }
+        if (PC < breakpoints_.size() && breakpoints_[PC]) {
+            std::cout << "Breakpoint at ";
+            Hex(std::cout, PC, 3) << '\n';
+            brk = true;
+        }
+        return brk;
+    }
+
+    void Debugger::Prompt(const State &state, bool &quit) {
+        for (const auto &hit: hits_) {
+            std::cout << "Watchpoint ";
+            Hex(std::cout, hit.watchpoint_.start_, 3) << "..";
+            Hex(std::cout, hit.watchpoint_.end_, 3) << ": " << ToString(hit.access_) << " of ";
+            Hex(std::cout, hit.addr_, 3) << "..";
+            Hex(std::cout, hit.addr_ + hit.size_, 3) << " by instruction at ";
+            Hex(std::cout, hit.PC_, 3) << '\n';
+        }
+        hits_.clear();
+
+        // Show the instruction about to be executed
+        Hex(std::cout, state.PC_, 3) << ": ";
+        const auto &RAM = state.RAM_;
+        Hex(std::cout, RAM[state.PC_ % RAM.size()] << 8 | RAM[(state.PC_ + 1) % RAM.size()], 4) << '\n';
+
+        std::string line;
+        while (true) {
+            std::cout << "(chippy) " << std::flush;
+            if (!std::getline(std::cin, line)) {
+                quit = true;
+                return;
+            }
+            if (Execute(line, state, quit)) {
+                return;
+            }
+        }
+    }
+
+    bool Debugger::Execute(const std::string &line, const State &state, bool &quit) {
+        std::istringstream in(line);
+        std::string command;
+        if (!(in >> command)) {
+            return false;
+        }
+
+        u_int16_t addr{};
+        if (command == "s") {
+            u_int16_t n = 1;
+            if (!(in >> n) || n == 0) {
+                n = 1;
+            }
+            steps_ = n;
+            paused_ = false;
+            return true;
+        }
+        if (command == "c") {
+            steps_ = 0;
+            paused_ = false;
+            return true;
+        }
+        if (command == "q") {
+            quit = true;
+            return true;
+        }
+
+        // Commands taking an address in RAM
+        if (command == "b" || command == "d" || command == "w" || command == "m") {
+            if (!ParseHex(in, addr)) {
+                std::cout << help;
+                return false;
+            }
+            if (addr >= state.RAM_.size()) {
+                std::cout << "Address out of range: ";
+                Hex(std::cout, addr, 3) << '\n';
+                return false;
+            }
+        }
+
+        if (command == "b") {
+            breakpoints_.set(addr);
+            return false;
+        }
+        if (command == "d") {
+            breakpoints_.reset(addr);
+            return false;
+        }
+        if (command == "w") {
+            u_int16_t size = 1;
+            auto access = ReadWrite;
+            std::string token;
+            while (in >> token) {
+                if (token == "r") {
+                    access = Read;
+                } else if (token == "w") {
+                    access = Write;
+                } else if (!ParseHex(token, size) || size == 0) {
+                    size = 1;
+                }
+            }
+            const auto end = std::min<unsigned>(addr + size, state.RAM_.size());
+            watchpoints_.push_back({addr, static_cast<u_int16_t>(end), access});
+            return false;
+        }
+        if (command == "u" && ParseHex(in, addr)) {
+            std::erase_if(watchpoints_, [addr](const auto &watchpoint) { return watchpoint.start_ == addr; });
+            return false;
+        }
+        if (command == "l") {
+            PrintPoints();
+            return false;
+        }
+        if (command == "r") {
+            PrintRegisters(state);
+            return false;
+        }
+        if (command == "m") {
+            u_int16_t size = 16;
+            if (!ParseHex(in, size)) {
+                size = 16;
+            }
+            PrintMemory(state, addr, size);
+            return false;
+        }
+
+        std::cout << help;
+        return false;
+    }
+
+    void Debugger::PrintRegisters(const State &state) const {
+        for (std::size_t n = 0; n < state.V_.size(); ++n) {
+            std::cout << 'V' << std::hex << std::uppercase << n << std::dec << '=';
+            Hex(std::cout, state.V_[n], 2) << (n % 8 == 7 ? '\n' : ' ');
+        }
+        std::cout << "I=";
+        Hex(std::cout, state.I_, 3) << " PC=";
+        Hex(std::cout, state.PC_, 3) << " DT=" << +state.delay_timer_ << " ST=" << +state.sound_timer_ << '\n';
+    }
+
+    void Debugger::PrintMemory(const State &state, const u_int16_t addr, const u_int16_t size) const {
+        for (std::size_t n = 0; n < size && addr + n < state.RAM_.size(); ++n) {
+            if (n % 16 == 0) {
+                Hex(std::cout, addr + n, 3) << ':';
+            }
+            std::cout << ' ';
+            Hex(std::cout, state.RAM_[addr + n], 2);
+            if (n % 16 == 15 || n + 1 == size || addr + n + 1 == state.RAM_.size()) {
+                std::cout << '\n';
+            }
+        }
+    }
+
+    void Debugger::PrintPoints() const {
+        for (std::size_t addr = 0; addr < breakpoints_.size(); ++addr) {
+            if (breakpoints_[addr]) {
+                std::cout << "Breakpoint ";
+                Hex(std::cout, addr, 3) << '\n';
+            }
+        }
+        for (const auto &watchpoint: watchpoints_) {
+            std::cout << "Watchpoint ";
+            Hex(std::cout, watchpoint.start_, 3) << "..";
+            Hex(std::cout, watchpoint.end_, 3) << ' ' << ToString(watchpoint.access_) << '\n';
+        }
+    }
+} // chip8
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace chip8 {
+    // Debug policy of the interpreter when no debugger is attached. All hooks are compiled out with
+    // `if constexpr`, so this instantiation of the execution core has no debugging overhead at all.
+    struct NoDebugger {
+        static constexpr bool enabled = false;
+    };
+
+    // Interactive console debugger: PC breakpoints, read/write watchpoints on RAM and single stepping.
+    class Debugger {
+    public:
+        static constexpr bool enabled = true;
+
+        enum Access : u_int8_t {
+            Read = 1,
+            Write = 2,
+            ReadWrite = Read | Write
+        };
+
+        // Called before every instruction, returns the time spent in the console so the caller can skip it
+        template<typename Interpreter>
+        std::chrono::steady_clock::duration Update(const Interpreter &interpreter, bool &quit) {
+            if (!ShouldBreak(interpreter.PC_)) {
+                return {};
+            }
+            const auto start = std::chrono::steady_clock::now();
+            Prompt({interpreter.RAM_, interpreter.V_, interpreter.I_, interpreter.PC_, interpreter.delay_timer_,
+                    interpreter.sound_timer_}, quit);
+            return std::chrono::steady_clock::now() - start;
+        }
+
+        // Called by the instruction that accesses RAM[addr..addr + size), PC being the address of that instruction
+        void OnAccess(u_int16_t PC, u_int16_t addr, u_int16_t size, Access access);
+
+    private:
+        struct State {
+            const std::array<u_int8_t, 4096> &RAM_;
+            const std::array<u_int8_t, 16> &V_;
+            u_int16_t I_;
+            u_int16_t PC_;
+            u_int8_t delay_timer_;
+            u_int8_t sound_timer_;
+        };
+
+        struct Watchpoint {
+            u_int16_t start_{};
+            u_int16_t end_{}; // Exclusive
+            Access access_{};
+        };
+
+        struct WatchpointHit {
+            Watchpoint watchpoint_{};
+            u_int16_t PC_{};
+            u_int16_t addr_{};
+            u_int16_t size_{};
+            Access access_{};
+        };
+
+        [[nodiscard]] bool ShouldBreak(u_int16_t PC);
+
+        void Prompt(const State &state, bool &quit);
+
+        [[nodiscard]] bool Execute(const std::string &line, const State &state, bool &quit); // Returns true to resume
+
+        void PrintRegisters(const State &state) const;
+
+        void PrintMemory(const State &state, u_int16_t addr, u_int16_t size) const;
+
+        void PrintPoints() const;
+
+        std::bitset<4096> breakpoints_{};
+        std::vector<Watchpoint> watchpoints_{};
+        std::vector<WatchpointHit> hits_{}; // Watchpoints hit by the last instruction
+
+        bool paused_{true}; // Start paused, so breakpoints can be set before the ROM runs
+        u_int32_t steps_{}; // Instructions left to step
+    };
+
+} // chip8
@@ -0,0 +1,174 @@
+#include "diagnostics.h"
+
+#include <iomanip>
+
+namespace chip8 {
+    using namespace std::chrono;
+
+    namespace {
+        constexpr auto mask = Diagnostics::ring_size - 1;
+        static_assert((Diagnostics::ring_size & mask) == 0, "Ring size must be a power of two");
+
+        constexpr auto window = 1s; // Rate limiting window
+
+        // pending_repeats_ layout: ring index of the event in the upper 16 bits, repeat count in the lower 48 bits
+        constexpr auto tag_shift = 48;
+        constexpr u_int64_t count_mask = (u_int64_t{1} << tag_shift) - 1;
+
+        constexpr u_int64_t Tag(const std::size_t index) {
+            return static_cast<u_int64_t>(index & 0xFFFF) << tag_shift;
+        }
+    }
+
+    const char *ToString(const Fault fault) {
+        switch (fault) {
+            case Fault::StackOverflow:
+                return "Stack overflow";
+            case Fault::StackUnderflow:
+                return "Stack underflow";
+            case Fault::UnsupportedInstruction:
+                return "Unsupported instruction";
+            case Fault::Count:
+                break;
+        }
+        return "Unknown fault";
+    }
+
+    Diagnostics::Diagnostics(std::ostream &out) : out_(out), window_start_(steady_clock::now()) {
+        worker_ = std::jthread([this](const std::stop_token &stop) {
+            while (!stop.stop_requested()) {
+                Drain(steady_clock::now());
+                std::this_thread::sleep_for(drain_interval);
+            }
+        });
+    }
+
+    Diagnostics::~Diagnostics() {
+        worker_.request_stop();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+
+        // Drain whatever is left, then report everything that was held back
+        Drain(steady_clock::now());
+        window_messages_ = 0; // Never hold back the final repeat count
+        FlushRepeats();
+        if (suppressed_ > 0) {
+            out_ << "Diagnostics: " << std::dec << suppressed_ << " message(s) suppressed\n";
+        }
+        PrintSummary(out_);
+    }
+
+    void Diagnostics::Report(const Fault fault, const u_int16_t PC, const u_int16_t opcode) {
+        counters_[static_cast<std::size_t>(fault)].fetch_add(1, std::memory_order_relaxed);
+
+        // Merge back-to-back duplicates instead of pushing them
+        const FaultEvent event{fault, PC, opcode};
+        if (has_pushed_ && event == last_pushed_) {
+            pending_repeats_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        const auto head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == ring_size) {
+            dropped_.fetch_add(1, std::memory_order_relaxed); // Ring full, the counter above still has it
+            return;
+        }
+
+        // Repeats of the previous event the consumer hasn't collected yet travel along with the new event
+        const auto previous = pending_repeats_.exchange(Tag(head), std::memory_order_acq_rel);
+        ring_[head & mask] = {event, previous & count_mask};
+        head_.store(head + 1, std::memory_order_release);
+
+        last_pushed_ = event;
+        has_pushed_ = true;
+    }
+
+    u_int64_t Diagnostics::Count(const Fault fault) const {
+        return counters_[static_cast<std::size_t>(fault)].load(std::memory_order_relaxed);
+    }
+
+    u_int64_t Diagnostics::Dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    void Diagnostics::PrintSummary(std::ostream &out) const {
+        u_int64_t total = 0;
+        for (const auto &counter: counters_) {
+            total += counter.load(std::memory_order_relaxed);
+        }
+        if (total == 0) {
+            return;
+        }
+
+        out << "Diagnostics summary:\n";
+        for (std::size_t f = 0; f < counters_.size(); ++f) {
+            const auto fault = static_cast<Fault>(f);
+            out << "  " << ToString(fault) << ": " << std::dec << Count(fault) << '\n';
+        }
+        if (Dropped() > 0) {
+            out << "  Dropped events: " << std::dec << Dropped() << '\n';
+        }
+    }
+
+    void Diagnostics::Drain(const steady_clock::time_point now) {
+        // Start a new rate limiting window
+        if (now - window_start_ >= window) {
+            FlushRepeats();
+            if (suppressed_ > 0) {
+                out_ << "Diagnostics: " << std::dec << suppressed_ << " message(s) suppressed\n";
+                suppressed_ = 0;
+            }
+            window_start_ = now;
+            window_messages_ = 0;
+        }
+
+        auto tail = tail_.load(std::memory_order_relaxed);
+        const auto head = head_.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            const auto &slot = ring_[tail & mask];
+            repeats_ += slot.previous_repeats_;
+            FlushRepeats();
+            Emit(slot.event_, 1);
+            last_ = slot.event_;
+        }
+        tail_.store(tail, std::memory_order_release);
+
+        if (tail != 0) {
+            CollectRepeats(tail - 1);
+        }
+    }
+
+    void Diagnostics::CollectRepeats(const std::size_t index) {
+        // Only take the count while it still belongs to last_, otherwise it travels with the next event
+        auto pending = pending_repeats_.load(std::memory_order_acquire);
+        while ((pending & ~count_mask) == Tag(index) && (pending & count_mask) != 0) {
+            if (pending_repeats_.compare_exchange_weak(pending, Tag(index), std::memory_order_acq_rel)) {
+                repeats_ += pending & count_mask;
+                return;
+            }
+        }
+    }
+
+    void Diagnostics::Emit(const FaultEvent &event, const u_int64_t repeats) {
+        if (window_messages_ == max_messages_per_second) {
+            ++suppressed_;
+            return;
+        }
+        ++window_messages_;
+
+        out_ << ToString(event.fault_) << ": 0x" << std::hex << std::setfill('0') << std::setw(4) << event.opcode_
+             << " at 0x" << std::setw(3) << event.PC_;
+        if (repeats > 1) {
+            out_ << " (repeated " << std::dec << repeats << " times)";
+        }
+        out_ << '\n';
+    }
+
+    void Diagnostics::FlushRepeats() {
+        if (repeats_ > 0) {
+            Emit(last_, repeats_);
+            repeats_ = 0;
+        }
+    }
+} // chip8
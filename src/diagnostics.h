@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <thread>
+
+#include <sys/types.h>
+
+namespace chip8 {
+    enum class Fault : u_int8_t {
+        StackOverflow,
+        StackUnderflow,
+        UnsupportedInstruction,
+        Count
+    };
+
+    struct FaultEvent {
+        Fault fault_{};
+
+        u_int16_t PC_{}; // Address of the faulting instruction
+
+        u_int16_t opcode_{};
+
+        bool operator==(const FaultEvent &) const = default;
+    };
+
+    // Collects faults raised by the interpreter without blocking it. Report() only bumps an atomic counter and
+    // pushes the event into a lock-free single-producer/single-consumer ring. Back-to-back duplicates are merged
+    // before they reach the ring, so it only holds distinct events. A background thread drains the ring and
+    // rate-limits what ends up on the output stream.
+    class Diagnostics {
+    public:
+        static constexpr std::size_t ring_size = 256; // Must be a power of two
+        static constexpr auto drain_interval = std::chrono::milliseconds(10);
+        static constexpr u_int32_t max_messages_per_second = 20;
+
+        explicit Diagnostics(std::ostream &out);
+
+        ~Diagnostics(); // Flushes pending events and prints a summary of all counters
+
+        Diagnostics(const Diagnostics &) = delete;
+
+        Diagnostics &operator=(const Diagnostics &) = delete;
+
+        void Report(Fault fault, u_int16_t PC, u_int16_t opcode); // Called from the interpreter thread only
+
+        [[nodiscard]] u_int64_t Count(Fault fault) const;
+
+        [[nodiscard]] u_int64_t Dropped() const; // Events lost because the ring was full
+
+        void PrintSummary(std::ostream &out) const;
+
+    private:
+        void Drain(std::chrono::steady_clock::time_point now);
+
+        void Emit(const FaultEvent &event, u_int64_t repeats);
+
+        void FlushRepeats();
+
+        void CollectRepeats(std::size_t index); // Take the producer's pending repeats of the event at index
+
+        struct Slot {
+            FaultEvent event_{};
+            u_int64_t previous_repeats_{}; // Repeats of the event in the previous slot
+        };
+
+        std::ostream &out_;
+
+        std::array<std::atomic<u_int64_t>, static_cast<std::size_t>(Fault::Count)> counters_{};
+        std::atomic<u_int64_t> dropped_{};
+
+        std::array<Slot, ring_size> ring_{};
+        std::atomic<std::size_t> head_{}; // Next slot to write, owned by producer
+        std::atomic<std::size_t> tail_{}; // Next slot to read, owned by consumer
+
+        // Repeats of the last pushed event not yet handed over, tagged in the upper bits with that event's index
+        std::atomic<u_int64_t> pending_repeats_{};
+
+        // Producer-side state, only touched by the interpreter thread
+        FaultEvent last_pushed_{};
+        bool has_pushed_{};
+
+        // Consumer-side state, only touched by the drain thread (or the destructor after it has joined)
+        FaultEvent last_{};
+        u_int64_t repeats_{}; // Occurrences of last_ not yet written out
+        std::chrono::steady_clock::time_point window_start_{};
+        u_int32_t window_messages_{};
+        u_int64_t suppressed_{}; // Messages dropped by the rate limiter
+
+        std::jthread worker_;
+    };
+
+    const char *ToString(Fault fault);
+
+} // chip8
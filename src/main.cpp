@@ -1,38 +1,76 @@
 #include <iostream>
 #include <filesystem>
+#include <string_view>
+#include <vector>
 
 #include "chip8.h"
 
+template<typename Debug>
+int Run(const chip8::Config &config, const char *ROM, const int IPS) {
+    chip8::Interpreter<Debug> chip8_interpreter{config};
+
+    if (!chip8_interpreter.GetDisplay().IsInitialized()) {
+        std::cerr << "Display could not be initialized, aborting program.";
+        return 1;
+    }
+
+    chip8_interpreter.Run(ROM, IPS);
+
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
-    if (argc < 2) {
-        std::cout << "Add path to ROM as input argument. [Optional parameter: IPS]\n";
+    chip8::Config config{false, false};
+    bool debug = false;
+
+    // Split options from positional arguments
+    std::vector<const char *> args;
+    for (auto n = 1; n < argc; ++n) {
+        const std::string_view arg = argv[n];
+        if (arg == "--cycle-timing") {
+            config.cycle_timing_ = true;
+        } else if (arg == "--display-wait") {
+            config.display_wait_ = true;
+        } else if (arg == "--unthrottled") {
+            config.unthrottled_ = true;
+        } else if (arg == "--debug") {
+            debug = true;
+        } else if (arg.starts_with("--")) {
+            std::cout << "Unknown option: " << arg << '\n';
+            return 1;
+        } else {
+            args.push_back(argv[n]);
+        }
+    }
+
+    if (args.empty()) {
+        std::cout << "Add path to ROM as input argument. [Optional parameter: IPS] "
+                     "[Options: --cycle-timing --display-wait --unthrottled --debug]\n";
         return 1;
-    } else if (argc > 3) {
+    } else if (args.size() > 2) {
         std::cout << "Too many input parameters\n";
         return 1;
     }
 
-    const auto ROM = argv[1];
+    // Without cycle timing the display wait is done by sleeping, which an unthrottled run never does
+    if (config.display_wait_ && config.unthrottled_ && !config.cycle_timing_) {
+        std::cerr << "--display-wait has no effect with --unthrottled unless --cycle-timing is set\n";
+    }
+
+    const auto ROM = args[0];
     if (!std::filesystem::exists(ROM)) {
         std::cerr << "Invalid ROM path\n";
     }
 
     // Instructions per second
     auto IPS = 1000;
-    if (argc == 3) {
-        IPS = std::atoi(argv[2]);
+    if (args.size() == 2) {
+        IPS = std::atoi(args[1]);
     }
 
-    chip8::Config config{false, false};
-
-    chip8::Interpreter chip8_interpreter{config};
-
-    if (!chip8_interpreter.GetDisplay().IsInitialized()) {
-        std::cerr << "Display could not be initialized, aborting program.";
-        return 1;
+    // The debugger is a separate instantiation of the interpreter, the default one has no debugging hooks at all
+    if (debug) {
+        return Run<chip8::Debugger>(config, ROM, IPS);
     }
-
-    chip8_interpreter.Run(ROM, IPS);
-
-    return 0;
+    return Run<chip8::NoDebugger>(config, ROM, IPS);
 }
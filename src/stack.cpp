@@ -1,21 +1,20 @@
 #include "stack.h"
 
-#include <iostream>
-
 namespace chip8 {
-    void stack::Push(const u_int16_t addr) {
+    bool stack::Push(const u_int16_t addr) {
         if (SP_ == stack_.size()) {
-            std::cerr << "STACK OVERFLOW\n";
-            return; // Stack overflow..
+            return false; // Stack overflow..
         }
         stack_[SP_++] = addr;
+        return true;
     }
 
-    u_int16_t stack::Pop() {
+    bool stack::Pop(u_int16_t &addr) {
         if (SP_ == 0) {
-            std::cerr << "STACK UNDERFLOW\n";
-            return 0;
+            addr = 0;
+            return false; // Stack underflow..
         }
-        return stack_[--SP_];
+        addr = stack_[--SP_];
+        return true;
     }
-} // chip8
\ No newline at end of file
+} // chip8
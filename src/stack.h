@@ -6,9 +6,9 @@ namespace chip8 {
 
     class stack {
     public:
-        void Push(u_int16_t addr);
+        [[nodiscard]] bool Push(u_int16_t addr); // Returns false on stack overflow
 
-        u_int16_t Pop();
+        [[nodiscard]] bool Pop(u_int16_t &addr); // Returns false on stack underflow, addr is then set to 0
 
     private:
         u_int8_t SP_{}; // Stack pointer, pointing to top-level of stack
@@ -16,4 +16,4 @@ namespace chip8 {
         std::array<u_int16_t, 16> stack_{};
     };
 
-} // chip8
\ No newline at end of file
+} // chip8